@@ -0,0 +1,115 @@
+#!/bin/sh
+
+# Times the rabin command's print, stats, compress and extract modes on a
+# corpus from mkcorpus, for several chunking settings, and prints the
+# chunk size distribution and dedup ratio for each. "make bench" in src
+# runs it after the librabinpoly microbenchmarks.
+
+cmd="rabin"
+gen="mkcorpus"
+size=256
+dups=30
+edits=20
+zeroes=5
+seed=1
+
+usage() {
+    echo >&2 "Usage: $0 [-c rabin-cmd] [-g mkcorpus-cmd] [-s size-MB] [-d duplicate-percent] [-E edit-percent] [-z zero-percent] [-r seed] [-e engine] [-j threads] [-k corpus-file]"
+}
+
+while getopts c:g:s:d:E:z:r:e:j:k: o ;do
+	case "$o" in
+	c)	cmd="$OPTARG";;
+	g)	gen="$OPTARG";;
+	s)	size="$OPTARG";;
+	d)	dups="$OPTARG";;
+	E)	edits="$OPTARG";;
+	z)	zeroes="$OPTARG";;
+	r)	seed="$OPTARG";;
+	e)	engine="-e $OPTARG";;
+	j)	threads="-j $OPTARG";;
+	k)	corpus="$OPTARG";;
+	[?])	usage
+		exit 1;;
+	esac
+done
+shift `expr $OPTIND - 1`
+
+for c in "$cmd" "$gen" ;do
+    if [ ! -x "$c" -o ! -f "$c" ] ;then
+	echo >&2 "error: $c does not seem to be a valid executable"
+	usage
+	exit 1
+    fi
+done
+
+tmp=`mktemp -d ${TMPDIR:-/tmp}/rabin-bench.XXXXXX` || exit 1
+trap 'rm -rf "$tmp"' 0
+trap 'exit 1' 1 2 15
+
+# -k keeps the corpus, and reuses it if it is already there
+if [ -z "$corpus" ] ;then
+    corpus="$tmp/corpus"
+fi
+if [ ! -f "$corpus" ] ;then
+    $gen -s $size -d $dups -e $edits -z $zeroes -r $seed "$corpus" || exit 1
+fi
+bytes=`wc -c <"$corpus"`
+
+now() {
+    date +%s.%N
+}
+
+# report mode start end [chunks]
+report() {
+    awk -v mode="$1" -v start="$2" -v end="$3" -v bytes="$bytes" \
+	-v chunks="$4" 'BEGIN {
+	secs = end - start
+	if (secs <= 0) secs = 0.000001
+	line = sprintf("  %-10s %8.3f s  %8.3f GB/s", mode, secs,
+		       bytes / secs / 1e9)
+	if (chunks != "")
+	    line = line sprintf("  %12.0f chunks/s", chunks / secs)
+	print line
+    }'
+}
+
+# the settings compared; each is a set of rabin options
+for settings in "" "-b 12 -m 1024 -M 32768" "-b 15 -m 8192 -M 131072" \
+    "-f 4096" "-f 8192" ;do
+    opts="$engine $threads $settings"
+    echo "rabin ${settings:-(defaults)}: $bytes bytes"
+
+    start=`now`
+    $cmd -p -R $opts "$corpus" 2>"$tmp/print" || exit 1
+    end=`now`
+    chunks=`sed -n 's/^chunks: //p' "$tmp/print"`
+    report print $start $end $chunks
+
+    rm -rf "$tmp/stats"
+    mkdir "$tmp/stats"
+    start=`now`
+    $cmd -S "$tmp/stats" $opts "$corpus" || exit 1
+    end=`now`
+    report stats $start $end $chunks
+
+    start=`now`
+    $cmd -c -o "$tmp/compressed" $opts "$corpus" || exit 1
+    end=`now`
+    report compress $start $end $chunks
+
+    start=`now`
+    $cmd -x -o "$tmp/extracted" $opts "$tmp/compressed" || exit 1
+    end=`now`
+    report extract $start $end $chunks
+
+    if ! cmp -s "$corpus" "$tmp/extracted" ;then
+	echo >&2 "error: extracted file differs from the corpus"
+	exit 1
+    fi
+    echo "  compressed size: `wc -c <"$tmp/compressed"`"
+
+    # the -R report, less the per-chunk lines
+    grep -v '^Found chunk\|^file name:' "$tmp/print" | sed 's/^/  /'
+    echo
+done
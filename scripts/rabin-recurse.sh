@@ -4,10 +4,10 @@ cmd="rabin"
 levels="-l 3"
 
 usage() {
-    echo >&2 "Usage: $0 -s stats-dir [-c rabin-cmd] [-l stats-levels] [-n notation] [-b bits] [-m min-chunk] [-M max-chunk] index-dir ..."
+    echo >&2 "Usage: $0 -s stats-dir [-c rabin-cmd] [-l stats-levels] [-n notation] [-b bits] [-m min-chunk] [-M max-chunk] [-f fixed-chunk] [-e engine] [-j threads] index-dir ..."
 }
 
-while getopts c:s:l:n:b:m:M:f: o ;do
+while getopts c:s:l:n:b:m:M:f:e:j: o ;do
 	case "$o" in
 	c)	cmd="$OPTARG";;
 	s)	statsDir="$OPTARG";;
@@ -17,6 +17,8 @@ while getopts c:s:l:n:b:m:M:f: o ;do
 	m)	min="-m $OPTARG";;
 	M)	max="-M $OPTARG";;
 	f)	fixed="-f $OPTARG";;
+	e)	engine="-e $OPTARG";;
+	j)	threads="-j $OPTARG";;
 	[?])	usage
 		exit 1;;
 	esac
@@ -41,12 +43,20 @@ if [ $# -eq 0 ] ;then
     exit 1;
 fi
 
+# keep only the directories, as the positional parameters
 for d in "$@" ;do
+    shift
     if [ ! -d "$d" ] ;then
 	echo >&2 "error: $d is not a directory; skipping"
 	continue
     fi
-    find "$d" -type f \
-         -exec $cmd -s $statsDir $levels $notation $bits $min $max \
-               $fixed {} \;
+    set -- "$@" "$d"
 done
+
+if [ $# -eq 0 ] ;then
+    exit 1
+fi
+
+# rabin descends the directories itself, with one set of threads for all
+$cmd -s $statsDir $levels $notation $bits $min $max $fixed $engine $threads \
+     "$@"
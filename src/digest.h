@@ -0,0 +1,49 @@
+/*
+ * Strong chunk digests for rabin -H: SHA-256 and BLAKE2b-256, written
+ * out here so the command needs no crypto library.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+ * USA
+ *
+ */
+
+#ifndef _DIGEST_H_
+#define _DIGEST_H_ 1
+
+#include <sys/types.h>
+
+// Strong digests for -H.  With one chosen, a chunk is known by its digest
+// instead of its rabin hash: the first 64 bits stand in for the hash
+// everywhere a hash is kept, and the whole digest is written out where
+// the output has room for it.
+#define DIGEST_NONE    0 // chunks are known by their rabin hash
+#define DIGEST_SHA256  1
+#define DIGEST_BLAKE2B 2 // BLAKE2b with a 256-bit result
+#define DIGEST_SIZE    32
+
+struct ChunkDigest
+{
+    u_int32_t     kind;
+    unsigned char bytes[DIGEST_SIZE];
+};
+
+void sha256(const unsigned char* data, size_t length, unsigned char* out);
+void blake2b256(const unsigned char* data, size_t length, unsigned char* out);
+
+// Fills in 'digest' with the 'kind' digest of 'data'.
+void computeDigest(u_int32_t kind, const unsigned char* data, size_t length,
+                   ChunkDigest* digest);
+
+#endif /* _DIGEST_H_ */
@@ -1,4 +1,4 @@
 make
-g++ -I. -O3 -c rabincmd.C 
-g++ rabincmd.o librabinpoly.a 
+g++ -I. -O3 -pthread -c rabincmd.C 
+g++ -pthread rabincmd.o librabinpoly.a 
 mv a.out rabin
@@ -41,24 +41,43 @@ class rabinpoly {
   int shift;
   u_int64_t T[256];		// Lookup table for mod
   void calcT ();
+protected:
+  // U[om] removes byte om from the front of a winsz byte window
+  void calcU (u_int64_t *U, unsigned int winsz) const;
 public:
   const u_int64_t poly;		// Actual polynomial
 
   explicit rabinpoly (u_int64_t poly);
   u_int64_t append8 (u_int64_t p, u_char m) const
   {
-    //printf("new p: %016llx\n", (p<<8) | m);
-    //printf("(old) p >> shift: %016llx\n", (p >> shift));
-    //printf("T[%d]: %016llx\n", p >> shift, T[p >> shift]);
-    long idx = p >> shift;
-    if( idx > (sizeof(T) / sizeof(*T)) )
-    {
-      fprintf(stderr, "T index %ld is out of bounds\n", idx);
-    }
-    return ((p << 8) | m) ^ T[idx];
+    // p is always reduced mod poly, so p >> shift indexes within T
+    return ((p << 8) | m) ^ T[p >> shift];
   }
 };
 
+// Hashes whole buffers, with the same results as append8 over each byte
+// in turn.  Where the CPU has carry-less multiplication (PCLMULQDQ) the
+// buffer is folded 64 bytes at a time, as fast CRCs do, and reduced with
+// Barrett's method; elsewhere, or with clmul false, eight tables take it
+// 8 bytes at a time.  Both work mod poly * x^(64 - degree), a degree 64
+// multiple of poly, and reduce mod poly only at the end.
+class rabinhash : public rabinpoly {
+  int degree;
+  u_int64_t qlow;		// poly * x^(64 - degree), less its x^64
+  u_int64_t S[8][256];		// S[j][b] = b x^(64 + 8j) mod that
+  u_int64_t K[9];		// folding and Barrett constants
+  bool useclmul;
+
+  u_int64_t slice8 (u_int64_t p, const u_char *buf, size_t len) const;
+  u_int64_t fold (u_int64_t p, const u_char *buf, size_t len) const;
+public:
+  explicit rabinhash (u_int64_t poly, bool clmul = true);
+
+  // p with all len bytes of buf appended, as by append8
+  u_int64_t append (u_int64_t p, const u_char *buf, size_t len) const;
+  bool clmul () const { return useclmul; }
+};
+
 class window : public rabinpoly {
 public:
   int size;
@@ -87,4 +106,52 @@ public:
   }
 };
 
+// Smallest power of two no less than N
+template <unsigned int N, unsigned int P = 1, bool DONE = (P >= N)>
+struct pow2ceil { enum { value = pow2ceil<N, P * 2>::value }; };
+template <unsigned int N, unsigned int P>
+struct pow2ceil<N, P, true> { enum { value = P }; };
+
+// A window whose size is fixed at compile time.  The ring buffer is
+// rounded up to a power of two so positions wrap with a mask instead of
+// a compare, and callers that already hold the input in memory can use
+// roll8 to pass in the outgoing byte themselves and skip the ring
+// entirely.  Fingerprints are the same as window's.
+template <unsigned int WINSZ = DEFAULT_WINDOW_SIZE>
+class fixedwindow : public rabinpoly {
+  enum { RINGSZ = pow2ceil<WINSZ>::value, RINGMASK = RINGSZ - 1 };
+
+  u_int64_t fingerprint;
+  unsigned int bufpos;
+  u_int64_t U[256];
+  u_char buf[RINGSZ];
+
+public:
+  enum { size = WINSZ };
+
+  explicit fixedwindow (u_int64_t poly)
+    : rabinpoly (poly)
+  {
+    calcU (U, WINSZ);
+    reset ();
+  }
+
+  // fp with om, the byte WINSZ positions back, slid out and m slid in
+  u_int64_t roll8 (u_int64_t fp, u_char om, u_char m) const {
+    return append8 (fp ^ U[om], m);
+  }
+
+  u_int64_t slide8 (u_char m) {
+    u_char om = buf[(bufpos - WINSZ) & RINGMASK];
+    buf[bufpos++ & RINGMASK] = m;
+    return fingerprint = roll8 (fingerprint, om, m);
+  }
+
+  void reset () {
+    fingerprint = 0;
+    bufpos = 0;
+    bzero ((char*) buf, sizeof (buf));
+  }
+};
+
 #endif /* !_RABINPOLY_H_ */